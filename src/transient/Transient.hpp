@@ -18,6 +18,9 @@ struct AMSExperiment {
     std::vector<double> dlist;
     std::vector<double> tlist;
 
+    //! group of ranks that holds the corresponding entry of xlist
+    std::vector<int> glist;
+
     double max_distance;
     double time;
     double initial_time;
@@ -32,6 +35,7 @@ struct AMSExperiment {
         xlist(),
         dlist(),
         tlist(),
+        glist(),
         max_distance(0.0),
         time(0.0),
         initial_time(0.0),
@@ -53,6 +57,7 @@ struct GPAExperiment {
     double probability;
     double distance;
     bool converged;
+    int group;
 };
 
 std::string mem2string(long long mem);
@@ -64,7 +69,11 @@ Transient<T>::Transient()
     x0_(nullptr),
     mfpt_(-1),
     probability_(-1),
-    engine_initialized_(false)
+    engine_initialized_(false),
+    num_groups_(1),
+    group_(0),
+    tickets_(0),
+    local_task_(0)
 {}
 
 template<class T>
@@ -75,7 +84,11 @@ Transient<T>::Transient(std::function<T(T const &, double)> time_step)
     x0_(nullptr),
     mfpt_(-1),
     probability_(-1),
-    engine_initialized_(false)
+    engine_initialized_(false),
+    num_groups_(1),
+    group_(0),
+    tickets_(0),
+    local_task_(0)
 {}
 
 template<class T>
@@ -87,7 +100,11 @@ Transient<T>::Transient(std::function<T(T const &, double)> time_step,
     x0_(new T(x0)),
     mfpt_(-1),
     probability_(-1),
-    engine_initialized_(false)
+    engine_initialized_(false),
+    num_groups_(1),
+    group_(0),
+    tickets_(0),
+    local_task_(0)
 {}
 
 template<class T>
@@ -102,7 +119,11 @@ Transient<T>::Transient(std::function<T(T const &, double)> time_step,
     vector_length_(vector_length),
     mfpt_(-1),
     probability_(-1),
-    engine_initialized_(false)
+    engine_initialized_(false),
+    num_groups_(1),
+    group_(0),
+    tickets_(0),
+    local_task_(0)
 {}
 
 template<class T>
@@ -118,7 +139,11 @@ Transient<T>::Transient(std::function<T(T const &, double)> time_step,
     vector_length_(vector_length),
     mfpt_(-1),
     probability_(-1),
-    engine_initialized_(false)
+    engine_initialized_(false),
+    num_groups_(1),
+    group_(0),
+    tickets_(0),
+    local_task_(0)
 {}
 
 template<class T>
@@ -328,15 +353,33 @@ void Transient<T>::naive(T const &x0) const
 {
     std::vector<GPAExperiment<T>> experiments(num_exp_);
 
-    int converged = 0;
     for (int i = 0; i < num_exp_; i++)
     {
         experiments[i].x = x0;
         experiments[i].converged = false;
-        transient_gpa(dt_, tmax_, experiments[i]);
+        experiments[i].group = owner(i);
 
-        if (experiments[i].converged)
-            converged++;
+        if (experiments[i].group == group_)
+        {
+            seed_noise(0, i);
+            transient_gpa(dt_, tmax_, experiments[i]);
+        }
+    }
+
+    int converged = 0;
+    for (int g = 0; g < num_groups_; g++)
+    {
+        std::vector<double> flags;
+        for (int i = 0; i < num_exp_; i++)
+            if (experiments[i].group == g)
+                flags.push_back(experiments[i].converged);
+
+        if (num_groups_ > 1)
+            broadcast_(flags, g);
+
+        for (double flag: flags)
+            if (flag > 0.5)
+                converged++;
     }
 
     probability_ = (double)converged / (double)num_exp_;
@@ -358,9 +401,18 @@ double Transient<T>::ams_elimination(
     std::vector<AMSExperiment<T> *> unused_experiments;
     std::vector<AMSExperiment<T> *> minimal_experiments;
 
+    if (method != "AMS" && method != "TAMS")
+    {
+        ERROR("Method " << method << " does not exist.", __FILE__, __LINE__);
+    }
+
     for (int i = 0; i < num_exp_; i++)
         reactive_experiments.push_back(&experiments[i]);
 
+    // Experiments that were read from file are held by this group
+    for (auto &exp: experiments)
+        exp.glist.resize(exp.dlist.size(), group_);
+
     for (auto exp: reactive_experiments)
     {
         if (!exp->converged)
@@ -408,9 +460,14 @@ double Transient<T>::ams_elimination(
 
         its_++;
 
+        // Select the starting points of all branches first. This does
+        // not depend on the branches themselves, since the experiments
+        // they start from are not eliminated.
+        std::vector<double> max_distances;
+        std::vector<int> prefix_lengths;
         for (auto &exp: minimal_experiments)
         {
-            double max_distance = exp->max_distance;
+            max_distances.push_back(exp->max_distance);
             int rnd_idx = randint(0, unused_experiments.size()-1);
             while (unused_experiments[rnd_idx]->max_distance <= exp->max_distance)
                 rnd_idx = randint(0, unused_experiments.size()-1);
@@ -438,15 +495,56 @@ double Transient<T>::ams_elimination(
                 rnd_exp->dlist.begin(), rnd_exp->dlist.begin() + same_distance_idx + 1);
             exp->tlist = std::vector<double>(
                 rnd_exp->tlist.begin(), rnd_exp->tlist.begin() + same_distance_idx + 1);
+            exp->glist = std::vector<int>(
+                rnd_exp->glist.begin(), rnd_exp->glist.begin() + same_distance_idx + 1);
+            prefix_lengths.push_back(same_distance_idx + 1);
+
+            // Any group may pick up the branch
+            replicate(*exp);
+        }
 
+        // Branches differ a lot in length, so instead of assigning them
+        // beforehand, groups take the next branch from a shared queue
+        // whenever they are idle
+        int num_branches = minimal_experiments.size();
+        std::vector<double> tasks;
+        for (int k = next_task(num_branches); k < num_branches;
+             k = next_task(num_branches))
+        {
+            tasks.push_back(k);
+
+            AMSExperiment<T> *exp = minimal_experiments[k];
+            seed_noise(its_, k);
             if (method == "AMS")
                 transient_ams(dt, tmax, *exp);
-            else if (method == "TAMS")
-                transient_tams(dt, tmax, *exp);
             else
-            {
-                ERROR("Method " << method << " does not exist.", __FILE__, __LINE__);
-            }
+                transient_tams(dt, tmax, *exp);
+        }
+
+        // Find out which group integrated which branch
+        std::vector<int> groups(num_branches, group_);
+        for (int g = 0; g < num_groups_ && num_groups_ > 1; g++)
+        {
+            std::vector<double> values(tasks);
+            broadcast_(values, g);
+            for (double k: values)
+                groups[(int)k] = g;
+        }
+
+        // Process the results in the order of the branches, so the
+        // outcome does not depend on the schedule
+        for (int k = 0; k < num_branches; k++)
+        {
+            AMSExperiment<T> *exp = minimal_experiments[k];
+
+            // Only the group that integrated the branch keeps its
+            // starting state
+            int start = prefix_lengths[k] - 1;
+            if (groups[k] != group_)
+                exp->xlist[start] = T();
+            exp->glist[start] = groups[k];
+
+            share(*exp, groups[k], prefix_lengths[k]);
 
             if (exp->converged)
                 converged++;
@@ -456,7 +554,7 @@ double Transient<T>::ams_elimination(
             INFO(method << ": " << its_ << " / " << maxit_ << ", "
                  << converged << " / " << num_exp_
                  << " converged with max distance "
-                 << max_distance << " -> "
+                 << max_distances[k] << " -> "
                  << exp->max_distance << " and t="
                  << exp->initial_time + exp->time
                  << " for experiment "
@@ -496,6 +594,9 @@ double Transient<T>::ams_elimination(
                     exp->tlist = std::vector<double>(
                         exp->tlist.begin() + min_max_idx,
                         exp->tlist.end());
+                    exp->glist = std::vector<int>(
+                        exp->glist.begin() + min_max_idx,
+                        exp->glist.end());
                 }
             }
             INFO("Finished cleanup");
@@ -537,37 +638,58 @@ void Transient<T>::ams(T const &x0) const
     double tmax = 100 * tmax_;
     time_steps_previous_write_ = 0;
 
+    std::vector<int> todo;
     for (int i = 0; i < num_init_exp_; i++)
-    {
-        if (experiments[i].initialized)
-            continue;
+        if (!experiments[i].initialized)
+            todo.push_back(i);
 
-        transient_start(x0, dt_, tmax, experiments[i]);
+    // Every group initializes one experiment per round
+    for (int first = 0; first < (int)todo.size(); first += num_groups_)
+    {
+        int last = std::min(first + num_groups_, (int)todo.size());
 
-        if (experiments[i].xlist.size() == 0)
+        for (int k = first; k < last; k++)
         {
-            ERROR("Initialization failed", __FILE__, __LINE__);
-        }
+            if (k - first != group_)
+                continue;
 
-        transient_ams(dt_, tmax, experiments[i]);
+            int i = todo[k];
+            seed_noise(0, i);
+            transient_start(x0, dt_, tmax, experiments[i]);
 
-        // Erase data that we do not need for later experiments
-        if (i >= num_exp_)
-        {
-            experiments[i].xlist = std::vector<T>();
-            experiments[i].dlist = std::vector<double>();
-            experiments[i].tlist = std::vector<double>();
+            if (experiments[i].xlist.size() > 0)
+                transient_ams(dt_, tmax, experiments[i]);
         }
 
-        if (experiments[i].converged)
-            converged++;
+        for (int k = first; k < last; k++)
+        {
+            int i = todo[k];
+            share(experiments[i], k - first, 0);
+
+            if (experiments[i].xlist.size() == 0)
+            {
+                ERROR("Initialization failed", __FILE__, __LINE__);
+            }
 
-        INFO("Initialization: " << i+1 << " / " << num_init_exp_ << ", "
-             << converged << " / " << num_init_exp_
-             << " converged with t="
-             << experiments[i].initial_time + experiments[i].time);
+            // Erase data that we do not need for later experiments
+            if (i >= num_exp_)
+            {
+                experiments[i].xlist = std::vector<T>();
+                experiments[i].dlist = std::vector<double>();
+                experiments[i].tlist = std::vector<double>();
+                experiments[i].glist = std::vector<int>();
+            }
 
-        write_helper(experiments, i+1);
+            if (experiments[i].converged)
+                converged++;
+
+            INFO("Initialization: " << i+1 << " / " << num_init_exp_ << ", "
+                 << converged << " / " << num_init_exp_
+                 << " converged with t="
+                 << experiments[i].initial_time + experiments[i].time);
+
+            write_helper(experiments, i+1);
+        }
     }
     INFO("");
 
@@ -625,28 +747,47 @@ void Transient<T>::tams(T const &x0) const
     int converged = 0;
     time_steps_previous_write_ = 0;
 
+    std::vector<int> todo;
     for (int i = 0; i < num_exp_; i++)
+        if (!experiments[i].initialized)
+            todo.push_back(i);
+
+    // Every group initializes one experiment per round
+    for (int first = 0; first < (int)todo.size(); first += num_groups_)
     {
-        if (experiments[i].initialized)
-            continue;
+        int last = std::min(first + num_groups_, (int)todo.size());
+
+        for (int k = first; k < last; k++)
+        {
+            int i = todo[k];
+            experiments[i].xlist.push_back(x0);
+            experiments[i].dlist.push_back(0);
+            experiments[i].tlist.push_back(0);
 
-        experiments[i].xlist.push_back(x0);
-        experiments[i].dlist.push_back(0);
-        experiments[i].tlist.push_back(0);
+            if (k - first == group_)
+            {
+                seed_noise(0, i);
+                transient_tams(dt_, tmax_, experiments[i]);
+            }
+        }
 
-        transient_tams(dt_, tmax_, experiments[i]);
+        for (int k = first; k < last; k++)
+        {
+            int i = todo[k];
+            share(experiments[i], k - first, 1);
 
-        experiments[i].initialized = true;
+            experiments[i].initialized = true;
 
-        if (experiments[i].converged)
-            converged++;
+            if (experiments[i].converged)
+                converged++;
 
-        INFO("Initialization: " << i+1 << " / " << num_exp_ << ", "
-             << converged << " / " << num_exp_
-             << " converged with t="
-             << experiments[i].time);
+            INFO("Initialization: " << i+1 << " / " << num_exp_ << ", "
+                 << converged << " / " << num_exp_
+                 << " converged with t="
+                 << experiments[i].time);
 
-        write_helper(experiments, i+1);
+            write_helper(experiments, i+1);
+        }
     }
     INFO("");
 
@@ -674,8 +815,10 @@ void Transient<T>::gpa(T const &x0) const
         experiments[i].probability = 1.0;
         experiments[i].distance = 0.0;
         experiments[i].converged = false;
+        experiments[i].group = owner(i);
     }
 
+    int its = 0;
     for (double t = tstep_; t <= tmax_; t += tstep_)
     {
         // Compute the mean weight
@@ -707,11 +850,55 @@ void Transient<T>::gpa(T const &x0) const
             }
         }
 
-        // Step until the next tstep and recompute weights
+        // Move the resampled particles to the group that integrates them
+        for (int i = 0; i < num_exp_ && num_groups_ > 1; i++)
+        {
+            if (experiments[i].group == owner(i))
+                continue;
+
+            experiments[i].x = transfer_(experiments[i].x,
+                                         experiments[i].group, owner(i));
+            experiments[i].group = owner(i);
+        }
+
+        // Step until the next tstep
+        its++;
+        for (int i = 0; i < num_exp_; i++)
+        {
+            if (experiments[i].group == group_)
+            {
+                seed_noise(its, i);
+                transient_gpa(dt_, tstep_, experiments[i]);
+            }
+        }
+
+        for (int g = 0; g < num_groups_ && num_groups_ > 1; g++)
+        {
+            std::vector<double> values;
+            for (int i = 0; i < num_exp_; i++)
+            {
+                if (experiments[i].group != g)
+                    continue;
+                values.push_back(experiments[i].distance);
+                values.push_back(experiments[i].converged);
+            }
+
+            broadcast_(values, g);
+
+            int j = 0;
+            for (int i = 0; i < num_exp_; i++)
+            {
+                if (experiments[i].group != g)
+                    continue;
+                experiments[i].distance = values[j++];
+                experiments[i].converged = values[j++] > 0.5;
+            }
+        }
+
+        // Recompute the weights
         int converged = 0;
         for (int i = 0; i < num_exp_; i++)
         {
-            transient_gpa(dt_, tstep_, experiments[i]);
             experiments[i].weight = W(experiments[i].distance);
             experiments[i].probability *= eta / experiments[i].weight;
 
@@ -755,6 +942,124 @@ void Transient<T>::set_random_engine(unsigned int seed)
     engine_initialized_ = true;
 }
 
+template<class T>
+void Transient<T>::set_ensemble(
+    int num_groups, int group,
+    std::function<T(T const &, int, int)> transfer,
+    std::function<void(std::vector<double> &, int)> broadcast,
+    std::function<int()> next_ticket)
+{
+    num_groups_ = num_groups;
+    group_ = group;
+    transfer_ = transfer;
+    broadcast_ = broadcast;
+    next_ticket_ = next_ticket;
+
+    if (num_groups_ > 1 && (read_ != "" || write_ != ""))
+    {
+        WARNING("Reading and writing transient data is not supported "
+                "with more than one group.", __FILE__, __LINE__);
+        read_ = "";
+        write_ = "";
+    }
+}
+
+template<class T>
+void Transient<T>::set_noise_seeder(std::function<void(int, int)> seed_noise)
+{
+    seed_noise_ = seed_noise;
+}
+
+template<class T>
+void Transient<T>::seed_noise(int its, int k) const
+{
+    if (seed_noise_)
+        seed_noise_(its, k);
+}
+
+template<class T>
+int Transient<T>::owner(int i) const
+{
+    return i % num_groups_;
+}
+
+template<class T>
+void Transient<T>::share(AMSExperiment<T> &exp, int g, int first) const
+{
+    if (num_groups_ > 1)
+    {
+        std::vector<double> values;
+        if (g == group_)
+        {
+            values.push_back(exp.max_distance);
+            values.push_back(exp.time);
+            values.push_back(exp.initial_time);
+            values.push_back(exp.return_time);
+            values.push_back(exp.initialized);
+            values.push_back(exp.converged);
+            values.insert(values.end(), exp.dlist.begin() + first, exp.dlist.end());
+            values.insert(values.end(), exp.tlist.begin() + first, exp.tlist.end());
+        }
+
+        broadcast_(values, g);
+
+        if (g != group_)
+        {
+            exp.max_distance = values[0];
+            exp.time = values[1];
+            exp.initial_time = values[2];
+            exp.return_time = values[3];
+            exp.initialized = values[4] > 0.5;
+            exp.converged = values[5] > 0.5;
+
+            int n = (values.size() - 6) / 2;
+            exp.dlist.resize(first);
+            exp.tlist.resize(first);
+            exp.dlist.insert(exp.dlist.end(), values.begin() + 6,
+                             values.begin() + 6 + n);
+            exp.tlist.insert(exp.tlist.end(), values.begin() + 6 + n,
+                             values.end());
+
+            // The new states are only available on group g
+            exp.xlist.resize(exp.dlist.size(), T());
+        }
+    }
+
+    exp.glist.resize(exp.dlist.size(), g);
+}
+
+template<class T>
+void Transient<T>::replicate(AMSExperiment<T> &exp) const
+{
+    int from = exp.glist.back();
+    for (int g = 0; g < num_groups_; g++)
+    {
+        if (g == from)
+            continue;
+
+        T x = transfer_(exp.xlist.back(), from, g);
+        if (g == group_)
+            exp.xlist.back() = x;
+    }
+}
+
+template<class T>
+int Transient<T>::next_task(int size) const
+{
+    // tickets_ is the first ticket of the current queue. Tickets are
+    // never reset, but every group draws exactly one ticket past the
+    // end of the queue, so the next queue starts size + num_groups_
+    // tickets later on all groups.
+    int ticket = (num_groups_ == 1) ? tickets_ + local_task_++ : next_ticket_();
+    int task = ticket - tickets_;
+    if (task >= size)
+    {
+        tickets_ += size + num_groups_;
+        local_task_ = 0;
+    }
+    return std::min(task, size);
+}
+
 template<class T>
 int Transient<T>::randint(int a, int b) const
 {
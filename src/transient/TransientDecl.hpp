@@ -3,6 +3,8 @@
 
 #include <random>
 #include <functional>
+#include <vector>
+#include <string>
 
 template<class T>
 struct AMSExperiment;
@@ -63,6 +65,16 @@ protected:
     // Random engine. FIXME: Does not work with omp!!!
     std::mt19937_64 *engine_;
 
+    // Ensemble parallelism, see set_ensemble()
+    int num_groups_;
+    int group_;
+    std::function<T(T const &, int, int)> transfer_;
+    std::function<void(std::vector<double> &, int)> broadcast_;
+    std::function<int()> next_ticket_;
+    std::function<void(int, int)> seed_noise_;
+    mutable int tickets_;
+    mutable int local_task_;
+
 public:
     Transient();
     Transient(std::function<T(T const &, double)> time_step);
@@ -128,6 +140,26 @@ public:
 
     void set_random_engine(unsigned int seed);
 
+    //! Distribute the experiments over num_groups groups of ranks, of
+    //! which this rank is in group. Every group integrates its own
+    //! experiments with its own time step. transfer(x, from, to)
+    //! copies a state from one group to another and broadcast(values,
+    //! root) sends values from a group to all ranks. Both are called
+    //! collectively in the same order on all ranks. next_ticket()
+    //! draws from a counter shared by all groups and is only
+    //! collective within a group.
+    void set_ensemble(int num_groups, int group,
+                      std::function<T(T const &, int, int)> transfer,
+                      std::function<void(std::vector<double> &, int)> broadcast,
+                      std::function<int()> next_ticket);
+
+    //! seed_noise(its, k) is called before trajectory k of step its
+    //! is integrated, where its = 0 is the initialization. It should
+    //! restart the noise of the time stepper from a seed that depends
+    //! on (its, k) only, so the results do not depend on the group
+    //! that integrates a trajectory.
+    void set_noise_seeder(std::function<void(int, int)> seed_noise);
+
     double get_probability();
     double get_mfpt();
 
@@ -137,6 +169,26 @@ protected:
 
     T time_step_helper(T const &x, double dt) const;
 
+    //! Restart the noise for trajectory k of step its, see
+    //! set_noise_seeder()
+    void seed_noise(int its, int k) const;
+
+    //! Group that integrates experiment i
+    int owner(int i) const;
+
+    //! Make the results of group g for experiment exp available on all
+    //! ranks, i.e. the scalar data and the entries of the distance and
+    //! time lists from first on. The states stay on group g.
+    void share(AMSExperiment<T> &exp, int g, int first) const;
+
+    //! Copy the last state of exp to all groups
+    void replicate(AMSExperiment<T> &exp) const;
+
+    //! Index of the next task of a queue of size tasks that is shared
+    //! by all groups, or size if the queue is empty. All groups keep
+    //! calling this until their queue is empty.
+    int next_task(int size) const;
+
     void write_helper(std::vector<AMSExperiment<T> > const &experiments,
                       int its) const;
 };